@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string_view>
+#include <utility>
+
+/*
+ * Glyph metrics and atlas bitmap of a font rasterized at build time
+ * by tools/embed_font (see gl_textrenderer_embed_font in CMakeLists.txt).
+ * The generated header defines these as constexpr, so no FreeType and
+ * no font file I/O is needed at runtime.
+ * */
+struct gl_embedded_glyph
+{
+    int size_x, size_y;       // width and height of the glyph bitmap
+    int bearing_x, bearing_y; // offset from baseline to left/top of glyph
+    unsigned int advance;     // offset to next glyph in 1/64th pixels
+    int atlas_x, atlas_y;     // top left of the glyph bitmap in the atlas
+};
+
+struct gl_embedded_font
+{
+    // inclusive range of the rasterized characters
+    unsigned char first_char;
+    unsigned char last_char;
+    int atlas_width;
+    int atlas_height;
+    // atlas_width * atlas_height 8-bit coverage values, top row first
+    const unsigned char* atlas;
+    // one entry per ASCII character, zeroed outside [first_char, last_char]
+    const gl_embedded_glyph* glyphs;
+
+    // same as gl_textrenderer::get_text_size, usable in constant expressions
+    constexpr std::pair<int, int> get_text_size(std::string_view text) const
+    {
+        int textWidth = 0;
+        int textHeight = 0;
+        for (char c: text)
+        {
+            auto index = static_cast<unsigned char>(c);
+            if (index >= 128)
+            {
+                continue;
+            }
+            const gl_embedded_glyph& glyph = glyphs[index];
+            // pick the biggest height in the text
+            if (glyph.size_y > textHeight)
+            {
+                textHeight = glyph.size_y;
+            }
+            textWidth += glyph.advance >> 6;
+        }
+        return {textWidth, textHeight};
+    }
+};
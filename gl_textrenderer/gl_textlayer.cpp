@@ -0,0 +1,352 @@
+#include "gl_textlayer.h"
+
+gl_textlayer::gl_textlayer(gl_textrenderer& textrenderer,
+                           unsigned int screen_width,
+                           unsigned int screen_height, int x, int y,
+                           unsigned int width, unsigned int height)
+        : m_textrenderer(textrenderer), m_screen_width(screen_width),
+          m_screen_height(screen_height), m_x(x), m_y(y), m_width(width),
+          m_height(height),
+          m_damage{0, 0, (int) width, (int) height}
+{
+    const std::string vertex_shader_source = R"(
+        #version 330 core
+        layout (location = 0) in vec2 position;
+        layout (location = 1) in vec2 texture_coordinates;
+
+        out vec2 TexCoords;
+
+        uniform mat4 projection;
+
+        void main()
+        {
+            gl_Position = projection * vec4(position.xy, 0.0, 1.0);
+            TexCoords = texture_coordinates;
+        }
+    )";
+    const std::string fragment_shader_source = R"(
+        #version 330 core
+        in vec2 TexCoords;
+        out vec4 color;
+
+        uniform sampler2D layer; // premultiplied text rendered by gl_textrenderer
+
+        void main()
+        {
+            color = texture(layer, TexCoords);
+        }
+    )";
+    m_shader_program = create_shader_program(vertex_shader_source,
+                                             fragment_shader_source);
+
+    setup_gl_objects();
+}
+
+gl_textlayer::~gl_textlayer()
+{
+    glDeleteFramebuffers(1, &m_fbo);
+    glDeleteTextures(1, &m_texture);
+    glDeleteVertexArrays(1, &m_vao);
+    glDeleteBuffers(1, &m_vbo);
+    glDeleteBuffers(1, &m_ebo);
+    glDeleteProgram(m_shader_program);
+}
+
+unsigned int gl_textlayer::add_text(std::string text, float x, float y,
+                                    std::array<float, 3> rgb)
+{
+    m_text entry = {text, x, y, rgb, {}};
+    entry.bounds = text_bounds(entry);
+    add_damage(entry.bounds);
+    m_texts.push_back(entry);
+    return m_texts.size() - 1;
+}
+
+void gl_textlayer::set_text(unsigned int id, std::string text)
+{
+    m_text& entry = m_texts[id];
+    if (entry.text == text)
+    {
+        return;
+    }
+    // the old text has to be erased and the new one drawn
+    add_damage(entry.bounds);
+    entry.text = text;
+    entry.bounds = text_bounds(entry);
+    add_damage(entry.bounds);
+}
+
+void gl_textlayer::set_color(unsigned int id, std::array<float, 3> rgb)
+{
+    m_text& entry = m_texts[id];
+    if (entry.rgb == rgb)
+    {
+        return;
+    }
+    entry.rgb = rgb;
+    add_damage(entry.bounds);
+}
+
+bool gl_textlayer::needs_update() const
+{
+    return m_dirty;
+}
+
+void gl_textlayer::draw()
+{
+    // render_text and the composite below change the blending,
+    // restored once the layer is drawn
+    bool blend = glIsEnabled(GL_BLEND) == GL_TRUE;
+    int blend_src_rgb, blend_dst_rgb, blend_src_alpha, blend_dst_alpha;
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blend_src_rgb);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blend_dst_rgb);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blend_src_alpha);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &blend_dst_alpha);
+
+    if (m_dirty)
+    {
+        update();
+    }
+
+    // the layer holds premultiplied colors
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glUseProgram(m_shader_program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glBindVertexArray(m_vao);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+
+    glBlendFuncSeparate(static_cast<GLenum>(blend_src_rgb),
+                        static_cast<GLenum>(blend_dst_rgb),
+                        static_cast<GLenum>(blend_src_alpha),
+                        static_cast<GLenum>(blend_dst_alpha));
+    if (!blend)
+    {
+        glDisable(GL_BLEND);
+    }
+}
+
+unsigned int gl_textlayer::create_shader_program(const std::string& vertex_source,
+                                                 const std::string& fragment_source)
+{
+    // vertex shader
+    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    const char* c_str_vertex = vertex_source.c_str();
+    glShaderSource(vertexShader, 1, &c_str_vertex, nullptr);
+    glCompileShader(vertexShader);
+    // check for shader compile errors
+    int success;
+    char infoLog[512];
+    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
+        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog
+                  << std::endl;
+    }
+    // fragment shader
+    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    const char* c_str_fragment = fragment_source.c_str();
+    glShaderSource(fragmentShader, 1, &c_str_fragment, nullptr);
+    glCompileShader(fragmentShader);
+    // check for shader compile errors
+    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
+        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog
+                  << std::endl;
+    }
+    // link shaders
+    unsigned int shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, vertexShader);
+    glAttachShader(shaderProgram, fragmentShader);
+    glLinkProgram(shaderProgram);
+    // check for linking errors
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
+        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog
+                  << std::endl;
+    }
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    return shaderProgram;
+}
+
+void gl_textlayer::setup_gl_objects()
+{
+    // offscreen texture the text is rendered into
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+    // the layer is drawn 1:1 onto the screen
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    int draw_framebuffer, read_framebuffer;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_framebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+    glGenFramebuffers(1, &m_fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, m_texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "ERROR::FRAMEBUFFER: Layer framebuffer is not complete"
+                  << std::endl;
+    }
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_framebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+
+    // one quad covering the layer's area on screen
+    float x0 = m_x;
+    float y0 = m_y;
+    float x1 = m_x + m_width;
+    float y1 = m_y + m_height;
+    std::vector<m_vertex> vertices = {
+            {{x0, y0}, {0.0f, 0.0f}},
+            {{x1, y0}, {1.0f, 0.0f}},
+            {{x0, y1}, {0.0f, 1.0f}},
+            {{x1, y1}, {1.0f, 1.0f}}
+    };
+    std::vector<unsigned int> indices = {
+            0, 1, 2, // first triangle
+            1, 2, 3  // second triangle
+    };
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+    glGenBuffers(1, &m_ebo);
+
+    glBindVertexArray(m_vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(m_vertex),
+                 vertices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
+                 indices.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(m_vertex),
+                          (const void*) offsetof(m_vertex, position));
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(m_vertex),
+                          (const void*) offsetof(m_vertex, texture_coordinates));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    glm::mat4 projection = glm::ortho(0.0f, (float) m_screen_width, 0.0f,
+                                      (float) m_screen_height);
+    glUseProgram(m_shader_program);
+    glUniformMatrix4fv(glGetUniformLocation(m_shader_program, "projection"), 1,
+                       GL_FALSE, glm::value_ptr(projection));
+    glUniform1i(glGetUniformLocation(m_shader_program, "layer"), 0);
+    glUseProgram(0);
+}
+
+gl_textlayer::m_rect gl_textlayer::text_bounds(const m_text& text)
+{
+    glm::ivec4 bounds = m_textrenderer.get_text_bounds(text.text);
+    // render_text may place glyphs at fractional positions,
+    // linear filtering then spreads them into the next pixel
+    const int margin = 1;
+    return {(int) std::floor(text.x) + bounds.x - margin,
+            (int) std::floor(text.y) + bounds.y - margin,
+            (int) std::ceil(text.x) + bounds.z + margin,
+            (int) std::ceil(text.y) + bounds.w + margin};
+}
+
+void gl_textlayer::add_damage(const m_rect& rect)
+{
+    if (!m_dirty)
+    {
+        m_damage = rect;
+        m_dirty = true;
+        return;
+    }
+    m_damage.x0 = std::min(m_damage.x0, rect.x0);
+    m_damage.y0 = std::min(m_damage.y0, rect.y0);
+    m_damage.x1 = std::max(m_damage.x1, rect.x1);
+    m_damage.y1 = std::max(m_damage.y1, rect.y1);
+}
+
+void gl_textlayer::update()
+{
+    m_dirty = false;
+
+    // clip the damage to the layer
+    m_rect damage = {
+            std::max(m_damage.x0, 0),
+            std::max(m_damage.y0, 0),
+            std::min(m_damage.x1, (int) m_width),
+            std::min(m_damage.y1, (int) m_height)
+    };
+    if (damage.x0 >= damage.x1 || damage.y0 >= damage.y1)
+    {
+        return;
+    }
+
+    // state changed below, restored once the layer is updated
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    int draw_framebuffer, read_framebuffer;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_framebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+    float clear_color[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_color);
+    int scissor_box[4];
+    glGetIntegerv(GL_SCISSOR_BOX, scissor_box);
+    bool scissor_test = glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE;
+    glm::mat4 projection = m_textrenderer.get_projection();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glViewport(0, 0, m_width, m_height);
+    m_textrenderer.set_projection(glm::ortho(0.0f, (float) m_width, 0.0f,
+                                             (float) m_height));
+
+    // everything outside the damaged area keeps its pixels
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(damage.x0, damage.y0, damage.x1 - damage.x0,
+              damage.y1 - damage.y0);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    for (m_text& text: m_texts)
+    {
+        const m_rect& bounds = text.bounds;
+        if (bounds.x1 <= damage.x0 || bounds.x0 >= damage.x1 ||
+            bounds.y1 <= damage.y0 || bounds.y0 >= damage.y1)
+        {
+            continue;
+        }
+        m_textrenderer.render_text(text.text, text.x, text.y, text.rgb);
+    }
+
+    glScissor(scissor_box[0], scissor_box[1], scissor_box[2], scissor_box[3]);
+    if (!scissor_test)
+    {
+        glDisable(GL_SCISSOR_TEST);
+    }
+    m_textrenderer.set_projection(projection);
+    glClearColor(clear_color[0], clear_color[1], clear_color[2],
+                 clear_color[3]);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_framebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <glbinding/gl/gl.h>
+
+#include <glm/glm.hpp>
+#include "glm/gtc/matrix_transform.hpp"
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "gl_textrenderer.h"
+
+using namespace gl;
+
+/*
+ * A group of strings rendered once into an offscreen texture
+ * and composited with a single quad per frame.
+ * Only the sub-rectangle touched by changed strings is redrawn.
+ * */
+class gl_textlayer
+{
+public:
+    // the layer covers width x height pixels with its bottom left at x, y
+    gl_textlayer(gl_textrenderer& textrenderer, unsigned int screen_width,
+                 unsigned int screen_height, int x, int y,
+                 unsigned int width, unsigned int height);
+
+    ~gl_textlayer();
+
+    // x, y are relative to the layer's bottom left, returns the text's id
+    unsigned int add_text(std::string text, float x, float y,
+                          std::array<float, 3> rgb = {1.0f, 1.0f, 1.0f});
+
+    void set_text(unsigned int id, std::string text);
+
+    void set_color(unsigned int id, std::array<float, 3> rgb);
+
+    // true if the next draw() has to re-render text into the layer
+    bool needs_update() const;
+
+    // re-renders the damaged area if needed and draws the layer
+    void draw();
+
+private:
+    struct m_vertex
+    {
+        glm::vec2 position;
+        glm::vec2 texture_coordinates;
+    };
+    // pixel rectangle in layer coordinates, x1/y1 exclusive
+    struct m_rect
+    {
+        int x0, y0, x1, y1;
+    };
+    struct m_text
+    {
+        std::string text;
+        float x, y;
+        std::array<float, 3> rgb;
+        m_rect bounds;
+    };
+
+    gl_textrenderer& m_textrenderer;
+    unsigned int m_screen_width;
+    unsigned int m_screen_height;
+    int m_x, m_y;
+    unsigned int m_width;
+    unsigned int m_height;
+
+    std::vector<m_text> m_texts;
+    bool m_dirty = true;
+    m_rect m_damage;
+
+    unsigned int m_shader_program;
+    unsigned int m_fbo, m_texture;
+    unsigned int m_vbo, m_vao, m_ebo;
+
+    unsigned int create_shader_program(const std::string& vertex_source,
+                                       const std::string& fragment_source);
+
+    void setup_gl_objects();
+
+    m_rect text_bounds(const m_text& text);
+
+    void add_damage(const m_rect& rect);
+
+    void update();
+};
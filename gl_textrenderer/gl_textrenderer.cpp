@@ -4,8 +4,23 @@ gl_textrenderer::gl_textrenderer(unsigned int screen_width,
                                  unsigned int screen_height,
                                  std::string font_path,
                                  int pixel_height)
-        : m_font_path(font_path),
-          m_projection(glm::ortho(0.0f, (float) screen_width, 0.0f,
+        : gl_textrenderer(screen_width, screen_height)
+{
+    m_font_path = font_path;
+    load_ascii_characters(pixel_height);
+}
+
+gl_textrenderer::gl_textrenderer(unsigned int screen_width,
+                                 unsigned int screen_height,
+                                 const gl_embedded_font& font)
+        : gl_textrenderer(screen_width, screen_height)
+{
+    load_embedded_characters(font);
+}
+
+gl_textrenderer::gl_textrenderer(unsigned int screen_width,
+                                 unsigned int screen_height)
+        : m_projection(glm::ortho(0.0f, (float) screen_width, 0.0f,
                                   (float) screen_height))
 {
     std::string vertex_shader = R"(
@@ -45,11 +60,14 @@ gl_textrenderer::gl_textrenderer(unsigned int screen_width,
     )";
 
     m_shader_program = create_shader_program(vertex_shader, fragment_shader);
-    load_ascii_characters(pixel_height);
 }
 
 gl_textrenderer::~gl_textrenderer()
 {
+    if (m_atlas_texture)
+    {
+        glDeleteTextures(1, &m_atlas_texture);
+    }
     glDeleteProgram(m_shader_program);
 }
 
@@ -58,7 +76,10 @@ void gl_textrenderer::render_text(std::string text, float x, float y,
                                   std::array<float, 3> rgb)
 {
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // alpha is accumulated separately so text drawn into a
+    // transparent gl_textlayer ends up with premultiplied colors
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+                        GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     glUseProgram(m_shader_program);
     glUniformMatrix4fv(glGetUniformLocation(m_shader_program, "projection"), 1,
@@ -113,22 +134,22 @@ void gl_textrenderer::render_text(std::string text, float x, float y,
 
         m_vertex v0 = {};
         v0.position = {xpos, ypos};
-        v0.texture_coordinates = {0.0f, 1.0f};
+        v0.texture_coordinates = {ch.TexTopLeft.x, ch.TexBottomRight.y};
         vertices.push_back(v0);
 
         m_vertex v1 = {};
         v1.position = {xpos + width, ypos};
-        v1.texture_coordinates = {1.0f, 1.0f};
+        v1.texture_coordinates = ch.TexBottomRight;
         vertices.push_back(v1);
 
         m_vertex v2 = {};
         v2.position = {xpos, ypos + height};
-        v2.texture_coordinates = {0.0f, 0.0f};
+        v2.texture_coordinates = ch.TexTopLeft;
         vertices.push_back(v2);
 
         m_vertex v3 = {};
         v3.position = {xpos + width, ypos + height};
-        v3.texture_coordinates = {1.0f, 0.0f};
+        v3.texture_coordinates = {ch.TexBottomRight.x, ch.TexTopLeft.y};
         vertices.push_back(v3);
 
         unsigned int VAO, VBO, EBO;
@@ -241,7 +262,9 @@ void gl_textrenderer::load_ascii_characters(int pixel_height)
                 texture,
                 glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
                 glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                static_cast<unsigned int>(face->glyph->advance.x)
+                static_cast<unsigned int>(face->glyph->advance.x),
+                glm::vec2(0.0f, 0.0f),
+                glm::vec2(1.0f, 1.0f)
         };
         m_characters.insert(std::pair<char, m_character>(c, character));
     }
@@ -252,6 +275,50 @@ void gl_textrenderer::load_ascii_characters(int pixel_height)
     FT_Done_FreeType(ft);
 }
 
+void gl_textrenderer::load_embedded_characters(const gl_embedded_font& font)
+{
+    // disable byte-alignment restriction
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // the whole atlas is uploaded once, glyphs only differ in texture coordinates
+    glGenTextures(1, &m_atlas_texture);
+    glBindTexture(GL_TEXTURE_2D, m_atlas_texture);
+    glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            GL_RED,
+            font.atlas_width,
+            font.atlas_height,
+            0,
+            GL_RED,
+            GL_UNSIGNED_BYTE,
+            font.atlas
+    );
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    float atlas_width = font.atlas_width;
+    float atlas_height = font.atlas_height;
+    for (int c = font.first_char; c <= font.last_char; c++)
+    {
+        const gl_embedded_glyph& glyph = font.glyphs[c];
+        m_character character = {
+                m_atlas_texture,
+                glm::ivec2(glyph.size_x, glyph.size_y),
+                glm::ivec2(glyph.bearing_x, glyph.bearing_y),
+                glyph.advance,
+                glm::vec2(glyph.atlas_x / atlas_width,
+                          glyph.atlas_y / atlas_height),
+                glm::vec2((glyph.atlas_x + glyph.size_x) / atlas_width,
+                          (glyph.atlas_y + glyph.size_y) / atlas_height)
+        };
+        m_characters.insert(std::pair<char, m_character>(c, character));
+    }
+}
+
 unsigned int gl_textrenderer::create_shader_program(std::string& vertex_src,
                                                     std::string& fragment_src)
 {
@@ -302,6 +369,16 @@ unsigned int gl_textrenderer::create_shader_program(std::string& vertex_src,
     return shaderProgram;
 }
 
+glm::mat4 gl_textrenderer::get_projection()
+{
+    return m_projection;
+}
+
+void gl_textrenderer::set_projection(glm::mat4 projection)
+{
+    m_projection = projection;
+}
+
 std::pair<int, int> gl_textrenderer::get_text_size(std::string text)
 {
     int textWidth = 0;
@@ -321,4 +398,43 @@ std::pair<int, int> gl_textrenderer::get_text_size(std::string text)
     return {textWidth, textHeight};
 }
 
+glm::ivec4 gl_textrenderer::get_text_bounds(std::string text)
+{
+    glm::ivec4 bounds = {0, 0, 0, 0};
+    bool empty = true;
+    int x = 0;
+    int first_bearing_x = 0;
+    for (char c: text)
+    {
+        m_character ch = m_characters[c];
+        // same placement as render_text
+        if (first_bearing_x == 0)
+        {
+            first_bearing_x = ch.Bearing.x;
+            ch.Bearing.x = 0;
+        } else
+        {
+            ch.Bearing.x -= first_bearing_x;
+        }
+        int xpos = x + ch.Bearing.x;
+        int ypos = -(ch.Size.y - ch.Bearing.y);
+        x += ch.Advance >> 6;
 
+        // glyphs like ' ' don't draw anything
+        if (ch.Size.x == 0 || ch.Size.y == 0)
+        {
+            continue;
+        }
+        glm::ivec4 glyph = {xpos, ypos, xpos + ch.Size.x, ypos + ch.Size.y};
+        if (empty)
+        {
+            bounds = glyph;
+            empty = false;
+        } else
+        {
+            bounds = {std::min(bounds.x, glyph.x), std::min(bounds.y, glyph.y),
+                      std::max(bounds.z, glyph.z), std::max(bounds.w, glyph.w)};
+        }
+    }
+    return bounds;
+}
@@ -10,9 +10,12 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 
+#include "gl_embedded_font.h"
+
 using namespace gl;
 
 class gl_textrenderer
@@ -21,6 +24,10 @@ public:
     gl_textrenderer(unsigned int screen_width, unsigned int screen_height,
                     std::string font_path, int pixel_height);
 
+    // uses a font rasterized at build time, see gl_embedded_font.h
+    gl_textrenderer(unsigned int screen_width, unsigned int screen_height,
+                    const gl_embedded_font& font);
+
     ~gl_textrenderer();
 
     void render_text(std::string text, float x, float y,
@@ -28,6 +35,15 @@ public:
 
     std::pair<int, int> get_text_size(std::string text);
 
+    // pixels covered by render_text's glyphs as {min x, min y, max x, max y},
+    // relative to the given x position and baseline
+    glm::ivec4 get_text_bounds(std::string text);
+
+    // projection render_text draws with, e.g. swapped by a gl_textlayer
+    glm::mat4 get_projection();
+
+    void set_projection(glm::mat4 projection);
+
 private:
     struct m_vertex
     {
@@ -43,10 +59,18 @@ private:
         glm::ivec2 Bearing;    // Offset from baseline to left/top of glyph
         // horizontal distance in 1/64th pixels from the origin to the next origin
         unsigned int Advance;    // Offset to advance to next glyph
+        // texture coordinates of the glyph's top left and bottom right,
+        // (0, 0) and (1, 1) unless the glyph lives in an atlas
+        glm::vec2 TexTopLeft;
+        glm::vec2 TexBottomRight;
     };
 
+    gl_textrenderer(unsigned int screen_width, unsigned int screen_height);
+
     void load_ascii_characters(int pixel_height);
 
+    void load_embedded_characters(const gl_embedded_font& font);
+
     unsigned int
     create_shader_program(std::string& vertex_src, std::string& fragment_src);
 
@@ -54,4 +78,5 @@ private:
     glm::mat4 m_projection;
     std::map<char, m_character> m_characters;
     unsigned int m_shader_program;
+    unsigned int m_atlas_texture = 0;
 };
@@ -7,6 +7,9 @@
 
 #include "gl_gridlines/gl_gridlines.h"
 #include "gl_textrenderer/gl_textrenderer.h"
+#include "gl_textrenderer/gl_textlayer.h"
+// generated at build time by gl_textrenderer_embed_font
+#include "ubuntu_r_13.h"
 
 using namespace gl;
 
@@ -32,26 +35,43 @@ int main()
     glbinding::initialize(glfwGetProcAddress);
 
     gl_gridlines gridlines(SCREEN_WIDTH, SCREEN_HEIGHT, 10, {0.0f, 0.6f, 1.0f});
-    gl_textrenderer textrenderer(SCREEN_WIDTH, SCREEN_HEIGHT,
-                                 "assets/Ubuntu-R.ttf", 13);
-    while (!glfwWindowShouldClose(window))
+    gl_textrenderer textrenderer(SCREEN_WIDTH, SCREEN_HEIGHT, ubuntu_r_13);
+    // the text never changes, so it is rendered once into a layer
+    gl_textlayer textlayer(textrenderer, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0,
+                           SCREEN_WIDTH, SCREEN_HEIGHT);
     {
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        textlayer.add_text("main( ) {", 10, SCREEN_HEIGHT - 20);
+        textlayer.add_text("extern a, b, c;", 20, SCREEN_HEIGHT - 40);
+        textlayer.add_text(
+                "putchar(a); putchar(b); putchar(c); putchar('!*n');", 20,
+                SCREEN_HEIGHT - 60);
+        textlayer.add_text("}", 10, SCREEN_HEIGHT - 80);
+        textlayer.add_text("a 'hell';", 10, SCREEN_HEIGHT - 100);
+        textlayer.add_text("b 'o, w';", 10, SCREEN_HEIGHT - 120);
+        textlayer.add_text("c 'orld';", 10, SCREEN_HEIGHT - 140);
+    }
+
+    // set when the window contents were lost, e.g. after being uncovered
+    bool redraw = true;
+    glfwSetWindowUserPointer(window, &redraw);
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) {
+        *static_cast<bool*>(glfwGetWindowUserPointer(window)) = true;
+    });
 
-        // render text
+    while (!glfwWindowShouldClose(window))
+    {
+        // nothing changed since the last frame, skip it
+        if (!redraw && !textlayer.needs_update())
         {
-            textrenderer.render_text("main( ) {", 10, SCREEN_HEIGHT - 20);
-            textrenderer.render_text("extern a, b, c;", 20, SCREEN_HEIGHT - 40);
-            textrenderer.render_text(
-                    "putchar(a); putchar(b); putchar(c); putchar('!*n');", 20,
-                    SCREEN_HEIGHT - 60);
-            textrenderer.render_text("}", 10, SCREEN_HEIGHT - 80);
-            textrenderer.render_text("a 'hell';", 10, SCREEN_HEIGHT - 100);
-            textrenderer.render_text("b 'o, w';", 10, SCREEN_HEIGHT - 120);
-            textrenderer.render_text("c 'orld';", 10, SCREEN_HEIGHT - 140);
+            glfwWaitEvents();
+            continue;
         }
+        redraw = false;
+
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
 
+        textlayer.draw();
         gridlines.draw();
 
         glfwSwapBuffers(window);
@@ -0,0 +1,168 @@
+/*
+ * Build time font rasterizer.
+ *
+ * usage: embed_font <font_path> <pixel_height> <name> <output_header>
+ *                   [first_char] [last_char]
+ *
+ * Rasterizes the characters first_char..last_char (default 32..126) of
+ * the font at the given pixel height, packs them into a single atlas
+ * and writes a header defining `name` as a constexpr gl_embedded_font.
+ * */
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// atlas width used unless a single glyph is wider
+const int ATLAS_WIDTH = 256;
+// empty pixels around each glyph so linear filtering doesn't bleed
+const int GLYPH_PADDING = 1;
+
+struct glyph
+{
+    int size_x = 0, size_y = 0;
+    int bearing_x = 0, bearing_y = 0;
+    unsigned int advance = 0;
+    int atlas_x = 0, atlas_y = 0;
+    std::vector<unsigned char> bitmap;
+};
+
+int main(int argc, char** argv)
+{
+    if (argc != 5 && argc != 7)
+    {
+        std::cout << "usage: " << argv[0]
+                  << " <font_path> <pixel_height> <name> <output_header>"
+                     " [first_char] [last_char]" << std::endl;
+        return 1;
+    }
+    std::string font_path = argv[1];
+    int pixel_height = std::stoi(argv[2]);
+    std::string name = argv[3];
+    std::string output_path = argv[4];
+    int first_char = argc == 7 ? std::stoi(argv[5]) : 32;
+    int last_char = argc == 7 ? std::stoi(argv[6]) : 126;
+    if (first_char < 0 || last_char > 127 || first_char > last_char)
+    {
+        std::cout << "ERROR::EMBED_FONT: charset must be within 0..127"
+                  << std::endl;
+        return 1;
+    }
+
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+        std::cout << "ERROR::FREETYPE: Could not init FreeType Library"
+                  << std::endl;
+        return 1;
+    }
+    FT_Face face;
+    if (FT_New_Face(ft, font_path.c_str(), 0, &face))
+    {
+        std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        return 1;
+    }
+    FT_Set_Pixel_Sizes(face, 0, pixel_height);
+
+    std::vector<glyph> glyphs(128);
+    int atlas_width = ATLAS_WIDTH;
+    for (int c = first_char; c <= last_char; c++)
+    {
+        if (FT_Load_Char(face, c, FT_LOAD_RENDER))
+        {
+            std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
+            return 1;
+        }
+        FT_Bitmap& bitmap = face->glyph->bitmap;
+        glyph& g = glyphs[c];
+        g.size_x = static_cast<int>(bitmap.width);
+        g.size_y = static_cast<int>(bitmap.rows);
+        g.bearing_x = face->glyph->bitmap_left;
+        g.bearing_y = face->glyph->bitmap_top;
+        g.advance = static_cast<unsigned int>(face->glyph->advance.x);
+        // copy row by row, the pitch may include alignment padding
+        for (int row = 0; row < g.size_y; row++)
+        {
+            const unsigned char* src = bitmap.buffer + row * bitmap.pitch;
+            g.bitmap.insert(g.bitmap.end(), src, src + g.size_x);
+        }
+        atlas_width = std::max(atlas_width, g.size_x + 2 * GLYPH_PADDING);
+    }
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+
+    // simple shelf packing in character order
+    int pen_x = GLYPH_PADDING;
+    int pen_y = GLYPH_PADDING;
+    int shelf_height = 0;
+    for (int c = first_char; c <= last_char; c++)
+    {
+        glyph& g = glyphs[c];
+        if (pen_x + g.size_x + GLYPH_PADDING > atlas_width)
+        {
+            pen_x = GLYPH_PADDING;
+            pen_y += shelf_height + GLYPH_PADDING;
+            shelf_height = 0;
+        }
+        g.atlas_x = pen_x;
+        g.atlas_y = pen_y;
+        pen_x += g.size_x + GLYPH_PADDING;
+        shelf_height = std::max(shelf_height, g.size_y);
+    }
+    int atlas_height = pen_y + shelf_height + GLYPH_PADDING;
+
+    std::vector<unsigned char> atlas(atlas_width * atlas_height, 0);
+    for (int c = first_char; c <= last_char; c++)
+    {
+        const glyph& g = glyphs[c];
+        for (int row = 0; row < g.size_y; row++)
+        {
+            std::copy_n(g.bitmap.begin() + row * g.size_x, g.size_x,
+                        atlas.begin() + (g.atlas_y + row) * atlas_width +
+                        g.atlas_x);
+        }
+    }
+
+    std::ofstream out(output_path);
+    if (!out)
+    {
+        std::cout << "ERROR::EMBED_FONT: Failed to open " << output_path
+                  << std::endl;
+        return 1;
+    }
+    out << "// generated by embed_font from "
+        << std::filesystem::path(font_path).filename().string() << " at "
+        << pixel_height << "px, do not edit\n"
+        << "#pragma once\n\n"
+        << "#include \"gl_textrenderer/gl_embedded_font.h\"\n\n";
+
+    out << "inline constexpr unsigned char " << name << "_atlas["
+        << atlas.size() << "] = {";
+    for (size_t i = 0; i < atlas.size(); i++)
+    {
+        out << (i % 16 == 0 ? "\n        " : " ") << int(atlas[i]) << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "inline constexpr gl_embedded_glyph " << name << "_glyphs[128] = {\n";
+    for (const glyph& g: glyphs)
+    {
+        out << "        {" << g.size_x << ", " << g.size_y << ", "
+            << g.bearing_x << ", " << g.bearing_y << ", " << g.advance << ", "
+            << g.atlas_x << ", " << g.atlas_y << "},\n";
+    }
+    out << "};\n\n";
+
+    out << "inline constexpr gl_embedded_font " << name << " = {\n"
+        << "        " << first_char << ", " << last_char << ", "
+        << atlas_width << ", " << atlas_height << ",\n"
+        << "        " << name << "_atlas, " << name << "_glyphs\n"
+        << "};\n";
+
+    return out ? 0 : 1;
+}